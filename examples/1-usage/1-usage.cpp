@@ -133,6 +133,10 @@ void loop() {
                 break;
             }
 
+            // Lets the back-off counter decay based on how long the connection was up
+            // when using BackoffHelper.withDecay(). Harmless if not connected.
+            BackoffHelper.disconnected();
+
             Log.info("going to sleep for %lu seconds", sleepSecs);
 #if HAL_PLATFORM_NRF52840
             // Gen 3 (nRF52840) does not suppport SLEEP_MODE_DEEP with a time in seconds
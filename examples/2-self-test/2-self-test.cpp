@@ -15,6 +15,8 @@ retained static TestRetained testRetained;
 
 retained static BackoffHelperRetained testRetained2;
 
+retained static BackoffHelperRetained testRetained3;
+
 enum {
     STATE_START = 0,
     STATE_SLEEP1,
@@ -85,6 +87,33 @@ void loop() {
         ASSERT_INT(expectedValue[0], BackoffHelper.getFailureSleepTimeSecs());
         ASSERT_INT(1, BackoffHelper.getNumTries());
 
+        // Test decay when success() is called before the clock is valid. The self-test runs 
+        // without the cloud, so the clock is only invalid on the first run after power-up.
+        if (!Time.isValid()) {
+            BackoffHelperClass test4(&testRetained3);
+
+            test4.success();
+            ASSERT_INT(0, test4.getNumTries());
+
+            test4.withDecay(1, 0);
+            for(int ii = 0; ii < 3; ii++) {
+                test4.getFailureSleepTimeSecs();
+            }
+            ASSERT_INT(3, test4.getNumTries());
+
+            // Connection time before the clock became valid still counts
+            test4.success();
+            ASSERT_INT(3, test4.getNumTries());
+            delay(2100);
+            Time.setTime(1600000000);
+            ASSERT_INT(1, test4.getNumTries());
+            test4.disconnected();
+            ASSERT_INT(1, test4.getNumTries());
+        }
+        else {
+            Log.info("clock is valid, skipping decay test with invalid clock");
+        }
+
         testRetained.state = STATE_SLEEP1;
 
 #if HAL_PLATFORM_NRF52840
@@ -164,6 +193,85 @@ void loop() {
             ASSERT_INT(3, BackoffHelper.getNumTries());
         }     
 
+        // Test decay on success instead of clearing the counter
+        {
+            BackoffHelperClass test3(&testRetained2);
+            test3.withDecay(60);
+
+            // The self-test runs without the cloud, so set the clock to make it valid
+            const time_t baseTime = 1600000000;
+            Time.setTime(baseTime);
+
+            ASSERT_INT(0, test3.getNumTries());
+            for(int ii = 0; ii < 5; ii++) {
+                test3.getFailureSleepTimeSecs();
+            }
+            ASSERT_INT(5, test3.getNumTries());
+
+            // A brief connection only gives a quarter step of credit
+            test3.success();
+            ASSERT_INT(5, test3.getNumTries());
+            Time.setTime(baseTime + 10);
+            test3.disconnected();
+            ASSERT_INT(5, test3.getNumTries());
+
+            // Four brief connections reduce tries by one
+            for(int ii = 0; ii < 3; ii++) {
+                Time.setTime(baseTime + 20 + ii * 20);
+                test3.success();
+                Time.setTime(baseTime + 30 + ii * 20);
+                test3.disconnected();
+            }
+            ASSERT_INT(4, test3.getNumTries());
+
+            // Each 60 seconds connected reduces tries by one more (credit 1)
+            Time.setTime(baseTime + 100);
+            test3.success();
+            Time.setTime(baseTime + 100 + 150);
+            ASSERT_INT(2, test3.getNumTries());
+            test3.disconnected();
+            ASSERT_INT(2, test3.getNumTries());
+
+            // Clock went backwards, no decay (credit 2). Calling success() again in the
+            // same connection does not add credit.
+            Time.setTime(baseTime + 1000);
+            test3.success();
+            test3.success();
+            Time.setTime(baseTime + 500);
+            test3.disconnected();
+            ASSERT_INT(2, test3.getNumTries());
+
+            // Brief connection (credit 3)
+            Time.setTime(baseTime + 1100);
+            test3.success();
+            Time.setTime(baseTime + 1110);
+            test3.disconnected();
+            ASSERT_INT(2, test3.getNumTries());
+
+            // Failure without disconnected() discards the connection time, but the credit 
+            // from success() still counts (credit 4 reduces tries by one)
+            Time.setTime(baseTime + 2000);
+            test3.success();
+            ASSERT_INT(1, test3.getNumTries());
+            Time.setTime(baseTime + 2000 + 600);
+            ASSERT_INT(expectedValue[1], test3.getFailureSleepTimeSecs());
+            ASSERT_INT(2, test3.getNumTries());
+
+            // A long connection clamps at 0
+            Time.setTime(baseTime + 3000);
+            test3.success();
+            Time.setTime(baseTime + 3000 + 60 * 60);
+            test3.disconnected();
+            ASSERT_INT(0, test3.getNumTries());
+            ASSERT_INT(expectedValue[0], test3.getFailureSleepTimeSecs());
+            ASSERT_INT(1, test3.getNumTries());
+
+            test3.withDecay(0);
+            test3.success();
+            ASSERT_INT(0, test3.getNumTries());
+            ASSERT_INT(3, BackoffHelper.getNumTries());
+        }
+
 
         Log.info("tests complete!");
         testRetained.state = STATE_WAIT;
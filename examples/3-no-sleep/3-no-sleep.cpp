@@ -74,6 +74,10 @@ void loop() {
 
         case STATE_RUNNING:
             if (!Particle.connected()) {
+                // Lets the back-off counter decay based on how long the connection was up
+                // when using BackoffHelper.withDecay()
+                BackoffHelper.disconnected();
+
                 state = STATE_WAIT_CONNECTED;
                 stateTime = millis();
             }
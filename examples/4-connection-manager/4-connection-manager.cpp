@@ -0,0 +1,35 @@
+// Cellular back-off using BackoffConnectionManager example
+
+// Public domain (CC0) 
+// Can be used in open or closed-source commercial projects and derivative works without attribution.
+
+#include "Particle.h"
+
+#include "BackoffConnectionManagerRK.h"
+
+// This example uses threading enabled and SEMI_AUTOMATIC mode
+SYSTEM_THREAD(ENABLED);
+SYSTEM_MODE(SEMI_AUTOMATIC);
+
+// Use the USB serial port for debugging logs
+SerialLogHandler logHandler;
+
+// How to wait after a failed connection attempt. This turns off the radio and keeps
+// running, like the 3-no-sleep example. You can instead use BackoffWaitDeepSleep,
+// BackoffWaitStopSleep, or BackoffWaitUltraLowPower.
+BackoffWaitRadioOff waitStrategy;
+
+BackoffConnectionManager connectionManager(waitStrategy);
+
+void setup() {
+    // Wait up to 6 minutes for the cloud connection before backing off
+    connectionManager.withConnectMaxMs(6 * 60 * 1000);
+}
+
+void loop() {
+    connectionManager.loop();
+
+    if (connectionManager.isConnected()) {
+        // Put your code that requires a cloud connection here
+    }
+}
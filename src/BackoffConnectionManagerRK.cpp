@@ -0,0 +1,152 @@
+#include "BackoffConnectionManagerRK.h"
+
+// Network interface that is turned off during the back-off period
+#if Wiring_Cellular
+#define BACKOFF_NETWORK Cellular
+#else
+#define BACKOFF_NETWORK WiFi
+#endif
+
+
+void BackoffWaitDeepSleep::start(int waitSecs) {
+#if HAL_PLATFORM_NRF52840
+    // Gen 3 (nRF52840) does not suppport SLEEP_MODE_DEEP with a time in seconds
+    // to wake up. This code uses stop mode sleep instead. Stop mode also wakes on
+    // WKP, so go back to sleep until the back-off period has expired.
+    time_t wakeTime = Time.now() + waitSecs;
+    for(time_t now = Time.now(); now < wakeTime; now = Time.now()) {
+        System.sleep(WKP, RISING, (int)(wakeTime - now));
+    }
+    System.reset();
+#else
+    System.sleep(SLEEP_MODE_DEEP, waitSecs);
+    // This is never reached; when the device wakes from sleep it will start over
+    // with setup()
+#endif
+}
+
+bool BackoffWaitDeepSleep::loop() {
+    return true;
+}
+
+
+void BackoffWaitStopSleep::start(int waitSecs) {
+    // Turn off the radio first so waking early doesn't resume the connection attempt.
+    // BackoffConnectionManager turns it back on in STATE_START.
+    Particle.disconnect();
+    BACKOFF_NETWORK.off();
+
+    wakeTime = Time.now() + waitSecs;
+    sleep(waitSecs);
+}
+
+bool BackoffWaitStopSleep::loop() {
+    time_t now = Time.now();
+    if (now >= wakeTime) {
+        return true;
+    }
+
+    // Woke up early, go back to sleep for the rest of the back-off period
+    sleep((int)(wakeTime - now));
+    return false;
+}
+
+void BackoffWaitStopSleep::sleep(int sleepSecs) {
+    System.sleep(WKP, RISING, sleepSecs);
+}
+
+
+void BackoffWaitRadioOff::start(int waitSecs) {
+    Particle.disconnect();
+    BACKOFF_NETWORK.off();
+
+    startMs = millis();
+    waitMs = (unsigned long) waitSecs * 1000;
+}
+
+bool BackoffWaitRadioOff::loop() {
+    return millis() - startMs >= waitMs;
+}
+
+
+void BackoffWaitUltraLowPower::sleep(int sleepSecs) {
+#if defined(SYSTEM_VERSION_v200) && SYSTEM_VERSION >= SYSTEM_VERSION_v200
+    SystemSleepConfiguration config;
+    config.mode(SystemSleepMode::ULTRA_LOW_POWER)
+        .duration((system_tick_t) sleepSecs * 1000);
+    System.sleep(config);
+#else
+    // ULTRA_LOW_POWER is not available, use stop mode sleep instead
+    BackoffWaitStopSleep::sleep(sleepSecs);
+#endif
+}
+
+
+BackoffConnectionManager::BackoffConnectionManager(BackoffWaitStrategy &waitStrategy, BackoffHelperClass &backoffHelper) :
+    waitStrategy(&waitStrategy), backoffHelper(backoffHelper) {
+
+}
+
+BackoffConnectionManager::~BackoffConnectionManager() {
+
+}
+
+void BackoffConnectionManager::loop() {
+    switch(state) {
+        case STATE_START:
+            // It's only necessary to turn the radio on and connect to the cloud. Stepping up
+            // one layer at a time and waiting for ready() can be done but there's little
+            // advantage to doing so.
+            BACKOFF_NETWORK.on();
+            Particle.connect();
+
+            state = STATE_WAIT_CONNECTED;
+            stateTime = millis();
+            break;
+
+        case STATE_WAIT_CONNECTED:
+            // Wait for the connection to the Particle cloud to complete
+            if (Particle.connected()) {
+                Log.info("connected to the cloud in %lu ms", millis() - stateTime);
+
+                // Successfully connected, clear the backoff counter
+                backoffHelper.success();
+
+                state = STATE_CONNECTED;
+                stateTime = millis();
+            }
+            else
+            if (millis() - stateTime >= connectMaxMs) {
+                // Took too long to connect, wait using the back-off table
+                int waitSecs = backoffHelper.getFailureSleepTimeSecs();
+
+                Log.info("failed to connect, waiting %d seconds", waitSecs);
+
+                state = STATE_WAIT_RETRY;
+                stateTime = millis();
+
+                // This may not return, depending on the strategy
+                waitStrategy->start(waitSecs);
+            }
+            break;
+
+        case STATE_CONNECTED:
+            if (!Particle.connected()) {
+                Log.info("lost cloud connection after %lu ms", millis() - stateTime);
+
+                // Lets the back-off counter decay based on how long the connection was up
+                backoffHelper.disconnected();
+
+                state = STATE_WAIT_CONNECTED;
+                stateTime = millis();
+            }
+            break;
+
+        case STATE_WAIT_RETRY:
+            if (waitStrategy->loop()) {
+                Log.info("retrying connection");
+                state = STATE_START;
+            }
+            break;
+    }
+}
@@ -0,0 +1,218 @@
+#ifndef __BACKOFFCONNECTIONMANAGERRK_H
+#define __BACKOFFCONNECTIONMANAGERRK_H
+
+// Github: https://github.com/rickkas7/BackoffHelperRK
+// License: MIT
+
+#include "BackoffHelperRK.h"
+
+/**
+ * @brief Abstract base class for the way the device waits between connection attempts
+ *
+ * BackoffConnectionManager calls start() once when a connection attempt fails, passing the
+ * back-off time from BackoffHelper. It then calls loop() from its own loop() until it returns
+ * true, at which point the radio is turned back on and the connection is retried.
+ *
+ * Strategies that sleep (and return from sleep) can do their work in start(), and sleep again
+ * from loop() if they woke before the back-off period expired. Strategies that reset the device
+ * never return from start().
+ */
+class BackoffWaitStrategy {
+public:
+    /**
+     * @brief Destructor.
+     */
+    virtual ~BackoffWaitStrategy() {}
+
+    /**
+     * @brief Begin waiting
+     *
+     * @param waitSecs amount of time to wait in seconds, as returned by getFailureSleepTimeSecs()
+     */
+    virtual void start(int waitSecs) = 0;
+
+    /**
+     * @brief Called from BackoffConnectionManager::loop() while waiting
+     *
+     * @return true when the wait is complete and the connection should be retried
+     */
+    virtual bool loop() = 0;
+};
+
+/**
+ * @brief Wait by going into SLEEP_MODE_DEEP. The device restarts from setup() on wake.
+ *
+ * Best suited for battery powered devices that wake periodically. On Gen 3 (nRF52840) devices,
+ * which do not support SLEEP_MODE_DEEP with a wake time, stop mode sleep is used followed
+ * by System.reset() so the behavior is the same.
+ */
+class BackoffWaitDeepSleep : public BackoffWaitStrategy {
+public:
+    virtual void start(int waitSecs);
+    virtual bool loop();
+};
+
+/**
+ * @brief Wait using stop mode sleep. Execution continues after the sleep completes.
+ *
+ * The cloud connection and radio are turned off before sleeping and stay off until the
+ * back-off period expires. If the device wakes early (such as a rising edge on WKP), loop()
+ * goes back to sleep for the remaining time.
+ */
+class BackoffWaitStopSleep : public BackoffWaitStrategy {
+public:
+    virtual void start(int waitSecs);
+    virtual bool loop();
+
+protected:
+    /**
+     * @brief Sleep for the specified number of seconds. Override to use a different sleep mode.
+     */
+    virtual void sleep(int sleepSecs);
+
+    /**
+     * @brief Time.now() value when the wait is complete
+     *
+     * The real-time clock keeps running during sleep, unlike millis() on some platforms, so it's
+     * used even if the time has not been synchronized from the cloud.
+     */
+    time_t wakeTime = 0;
+};
+
+/**
+ * @brief Turn off the radio and keep running, without sleeping
+ *
+ * This is the behavior of the 3-no-sleep example and is appropriate for externally powered
+ * devices that need to keep running their own code during the back-off period.
+ */
+class BackoffWaitRadioOff : public BackoffWaitStrategy {
+public:
+    virtual void start(int waitSecs);
+    virtual bool loop();
+
+protected:
+    /**
+     * @brief millis() value when start() was called
+     */
+    unsigned long startMs = 0;
+
+    /**
+     * @brief Amount of time to wait in milliseconds
+     */
+    unsigned long waitMs = 0;
+};
+
+/**
+ * @brief Wait using ULTRA_LOW_POWER sleep mode. Execution continues after the sleep completes.
+ *
+ * This requires Device OS 2.0.0 or later. On earlier versions stop mode sleep is used instead.
+ */
+class BackoffWaitUltraLowPower : public BackoffWaitStopSleep {
+protected:
+    virtual void sleep(int sleepSecs);
+};
+
+
+/**
+ * @brief Connection manager that runs the connect, wait, back-off finite state machine
+ *
+ * This replaces the state machine in the 1-usage and 3-no-sleep examples. Call loop() from
+ * the application loop(); it never blocks, except within a sleep wait strategy.
+ *
+ * On successful connection BackoffHelper.success() is called. If the cloud connection
+ * cannot be established within the connect timeout, getFailureSleepTimeSecs() determines
+ * how long to wait, and the wait strategy is used to wait for that period.
+ *
+ * The wait strategy object must remain valid for the life of the manager, so it's typically
+ * a global variable.
+ */
+class BackoffConnectionManager {
+public:
+    /**
+     * @brief States in the finite state machine
+     */
+    enum State {
+        STATE_START = 0,        //!< Turn on the radio and start connecting
+        STATE_WAIT_CONNECTED,   //!< Wait for Particle.connected() or the connect timeout
+        STATE_CONNECTED,        //!< Connected to the cloud
+        STATE_WAIT_RETRY        //!< Waiting for the back-off period to expire using the wait strategy
+    };
+
+    /**
+     * @brief Construct a connection manager
+     *
+     * @param waitStrategy the strategy used to wait after a failed connection attempt.
+     *
+     * @param backoffHelper the back-off counter to use. Default is the global BackoffHelper object.
+     */
+    BackoffConnectionManager(BackoffWaitStrategy &waitStrategy, BackoffHelperClass &backoffHelper = BackoffHelper);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~BackoffConnectionManager();
+
+    /**
+     * @brief Sets the maximum amount of time to wait for the cloud connection in milliseconds
+     *
+     * The default is 5 minutes. If you set this shorter, on Gen 2 devices the modem may not get
+     * power cycled which may help with reconnection. When using deep sleep, 4 to 4.5 minutes is
+     * reasonable.
+     */
+    BackoffConnectionManager &withConnectMaxMs(unsigned long connectMaxMs) { this->connectMaxMs = connectMaxMs; return *this; };
+
+    /**
+     * @brief Changes the wait strategy
+     *
+     * This should not be called while in STATE_WAIT_RETRY.
+     */
+    BackoffConnectionManager &withWaitStrategy(BackoffWaitStrategy &waitStrategy) { this->waitStrategy = &waitStrategy; return *this; };
+
+    /**
+     * @brief Call this from loop(). It does not block.
+     */
+    void loop();
+
+    /**
+     * @brief Returns the current state of the finite state machine
+     */
+    State getState() const { return state; };
+
+    /**
+     * @brief Returns true if the manager has seen a successful cloud connection that is still up
+     */
+    bool isConnected() const { return state == STATE_CONNECTED; };
+
+    /**
+     * @brief Default connect timeout in milliseconds (5 minutes)
+     */
+    static const unsigned long DEFAULT_CONNECT_MAX_MS = 5 * 60 * 1000;
+
+protected:
+    /**
+     * @brief Wait strategy to use on failure to connect
+     */
+    BackoffWaitStrategy *waitStrategy;
+
+    /**
+     * @brief Back-off counter
+     */
+    BackoffHelperClass &backoffHelper;
+
+    /**
+     * @brief Maximum time to wait for connection in milliseconds
+     */
+    unsigned long connectMaxMs = DEFAULT_CONNECT_MAX_MS;
+
+    /**
+     * @brief Current state
+     */
+    State state = STATE_START;
+
+    /**
+     * @brief millis() value when the current state was entered
+     */
+    unsigned long stateTime = 0;
+};
+
+#endif /* __BACKOFFCONNECTIONMANAGERRK_H */
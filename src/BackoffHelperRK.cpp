@@ -1,6 +1,6 @@
 #include "BackoffHelperRK.h"
 
-// Global retained data for the global BackoffHelper object. This uses 8 bytes of retained RAM.
+// Global retained data for the global BackoffHelper object. This uses 12 bytes of retained RAM.
 static retained BackoffHelperRetained builtInRetainedData;
 
 // Global BackoffHelper object. This is declared extern in the .h file.
@@ -36,13 +36,59 @@ BackoffHelperClass &BackoffHelperClass::withDefaultTable() {
 
 void BackoffHelperClass::success() {
     validate();
-    retainedData->tries = 0;
+    if (decaySecs == 0) {
+        retainedData->tries = 0;
+        retainedData->successCredit = 0;
+        retainedData->successTime = 0;
+        return;
+    }
+
+    if (connected) {
+        // Already counted this connection
+        updateSuccessTime();
+        return;
+    }
+
+    // Each connection only gives a fraction of a step; the rest comes from the uptime
+    if (retainedData->tries > 0 && successesPerStep != 0) {
+        if (++retainedData->successCredit >= successesPerStep) {
+            retainedData->tries--;
+            retainedData->successCredit = 0;
+        }
+    }
+    if (retainedData->tries == 0) {
+        retainedData->successCredit = 0;
+    }
+
+    // If a previous connection was never ended with disconnected() (such as a reset) its length 
+    // is unknown, so it is discarded without any decay.
+    connected = true;
+    successMillis = millis();
+    successPending = true;
+    retainedData->successTime = 0;
+    updateSuccessTime();
+}
+
+void BackoffHelperClass::disconnected() {
+    validate();
+    updateSuccessTime();
+    retainedData->tries = getDecayedTries();
+    retainedData->successTime = 0;
+    successPending = false;
+    connected = false;
 }
 
 int BackoffHelperClass::getFailureSleepTimeSecs() {
     int result;
 
     validate();
+
+    // A connection that was not ended with disconnected() has an unknown length (it may include
+    // sleep and this failed connection attempt), so it is discarded without any decay.
+    retainedData->successTime = 0;
+    successPending = false;
+    connected = false;
+
     if (retainedData->tries < backoffTableNumElem) {
         result = (int)(backoffTable[retainedData->tries] * 60);
     }
@@ -55,7 +101,34 @@ int BackoffHelperClass::getFailureSleepTimeSecs() {
 
 uint16_t BackoffHelperClass::getNumTries() {
     validate();
-    return retainedData->tries;
+    updateSuccessTime();
+    return getDecayedTries();
+}
+
+uint16_t BackoffHelperClass::getDecayedTries() const {
+    uint16_t tries = retainedData->tries;
+
+    if (decaySecs != 0 && retainedData->successTime != 0 && Time.isValid()) {
+        uint32_t now = (uint32_t) Time.now();
+        if (now > retainedData->successTime) {
+            uint32_t steps = (now - retainedData->successTime) / decaySecs;
+            tries = (steps >= tries) ? 0 : (uint16_t)(tries - steps);
+        }
+    }
+    return tries;
+}
+
+void BackoffHelperClass::updateSuccessTime() {
+    if (successPending && Time.isValid()) {
+        // The clock may not have been valid yet when success() was called, so back-date the
+        // connection time by how long it has been up. A connection never lasts across a reset,
+        // so millis() is sufficient for this.
+        uint32_t now = (uint32_t) Time.now();
+        uint32_t upSecs = (millis() - successMillis) / 1000;
+
+        retainedData->successTime = (upSecs < now) ? (now - upSecs) : 1;
+        successPending = false;
+    }
 }
 
 
@@ -65,7 +138,8 @@ void BackoffHelperClass::validate() {
         retainedData->magic = BACKOFFHELPER_RETAINED_MAGIC;
         retainedData->version = BACKOFFHELPER_RETAINED_VERSION;
         retainedData->tries = 0;
-        retainedData->reserved = 0; 
+        retainedData->successCredit = 0;
+        retainedData->successTime = 0;
     }
 }
 
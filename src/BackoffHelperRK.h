@@ -9,11 +9,12 @@
 /**
  * @brief This structure is stored in retained memory
  */
-typedef struct { // 8 bytes
+typedef struct { // 12 bytes
     uint32_t    magic;
     uint8_t     version;
-    uint8_t     reserved;
+    uint8_t     successCredit; //!< Number of successes counted toward the next one-step reduction when using decay
     uint16_t    tries;
+    uint32_t    successTime; //!< Time.now() when the connection started when using decay, 0 if not connected or unknown
 } BackoffHelperRetained;
 
 
@@ -71,11 +72,48 @@ public:
      */
     BackoffHelperClass &withDefaultTable();
 
+    /**
+     * @brief Reduce the tries counter gradually on success instead of clearing it
+     * 
+     * @param decaySecs number of seconds the connection must stay up to reduce tries by one. 0 
+     * (the default) disables decay, so success() clears the tries counter immediately.
+     * 
+     * @param successesPerStep number of connections that reduce tries by one, regardless of how long
+     * they stay up. Default is 4, so each success lowers the back-off level by a quarter step. 0 means
+     * only the connection time reduces tries.
+     * 
+     * With decay enabled, success() gives a small credit and records the start of the connection. Each 
+     * decaySecs seconds the connection stays up reduces tries by one more, which is applied when 
+     * disconnected() is called. This keeps a site where the connection is flapping from going back to 
+     * short retry times after brief connections, while devices that only connect briefly before sleeping 
+     * still recover over time.
+     * 
+     * The connection start time is stored in retained memory using Time.now(). If the clock is not
+     * yet valid when success() is called, it is recorded once it becomes valid.
+     */
+    BackoffHelperClass &withDecay(uint32_t decaySecs, uint8_t successesPerStep = 4) { 
+        this->decaySecs = decaySecs; this->successesPerStep = successesPerStep; return *this; 
+    };
+
     /**
      * @brief Call this to clear the tries counter so the next failure will start off with a short delay
+     * 
+     * If withDecay() is used, this instead adds a small credit toward reducing tries (see withDecay())
+     * and records the time of the connection, and tries is reduced further based on how long the 
+     * connection stays up. Additional calls before disconnected() or getFailureSleepTimeSecs() are
+     * part of the same connection and are ignored.
      */
     void success();
 
+    /**
+     * @brief Call this when the connection is lost or before disconnecting to sleep
+     * 
+     * This is only necessary when using withDecay(). It reduces the tries counter based on how long
+     * the connection was up. If you do not call it, the connection time does not reduce the tries 
+     * counter, only the credit given by success().
+     */
+    void disconnected();
+
     /**
      * @brief Call this on failure to get the amount of time to sleep (or wait) in seconds
      * 
@@ -92,13 +130,15 @@ public:
      * This is zero if the last call was success and increases as the number of times getFailureSleepTimeSecs()
      * is called. This will increase beyond backoffTableNumElem even though the value of getFailureSleepTimeSecs()
      * stops increasing at the last element of backoffTable.
+     * 
+     * When using withDecay() and connected, this includes the decay for the time connected so far.
      */
     uint16_t getNumTries();
 
     /**
      * @brief Used internally to validate the retained memory
      * 
-     * This is called from success(), getFailureSleepTimeSecs(), and getNumTries(). If the retained memory is not
+     * This is called from success(), disconnected(), getFailureSleepTimeSecs(), and getNumTries(). If the retained memory is not
      * valid then the number of tries is set to 0.
      */
     void validate();
@@ -111,7 +151,7 @@ public:
     /**
      * @brief Version number of the retained data structure
      */
-    static const uint8_t BACKOFFHELPER_RETAINED_VERSION = 1;
+    static const uint8_t BACKOFFHELPER_RETAINED_VERSION = 2;
 
     /**
      * @brief  Backoff times in minutes, used when the default contructor is used
@@ -121,6 +161,16 @@ public:
     static const uint8_t standardBackoffTable[];
 
 protected:
+    /**
+     * @brief Returns the tries counter reduced by the time connected since success(), when using withDecay()
+     */
+    uint16_t getDecayedTries() const;
+
+    /**
+     * @brief Records the connection start time if success() was called before the clock was valid
+     */
+    void updateSuccessTime();
+
     /**
      * @brief Pointer to an array of int delay times in minutes 
      * 
@@ -138,7 +188,32 @@ protected:
     size_t backoffTableNumElem;
 
     /**
-     * @brief This is the data stored in retained memory (8 bytes)
+     * @brief Seconds of connection time to reduce tries by one. 0 = clear tries on success (default).
+     */
+    uint32_t decaySecs = 0;
+
+    /**
+     * @brief Number of successes that reduce tries by one when using decay. 0 = no credit for success.
+     */
+    uint8_t successesPerStep = 4;
+
+    /**
+     * @brief true if success() was called and the connection has not ended yet
+     */
+    bool connected = false;
+
+    /**
+     * @brief millis() value when success() was called
+     */
+    unsigned long successMillis = 0;
+
+    /**
+     * @brief true if success() was called but the clock was not valid yet to record successTime
+     */
+    bool successPending = false;
+
+    /**
+     * @brief This is the data stored in retained memory (12 bytes)
      */
     BackoffHelperRetained *retainedData;
 };